@@ -0,0 +1,17 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+// Where a view looks in the world. scrollX/scrollY are in unzoomed
+// isometric pixels, as World::render has always used them.
+struct Camera {
+    float scrollX = 0.0f;
+    float scrollY = 0.0f;
+    float zoom = 1.0f;  // default: 100%
+};
+
+// A camera drawn into a rectangle of the window. Several viewports can
+// render the same World in one frame (split-screen, overview, ...).
+struct Viewport {
+    SDL_Rect rect;
+    Camera camera;
+};
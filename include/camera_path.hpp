@@ -0,0 +1,15 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "input_event.hpp"
+
+class World;
+
+// Scripted input streams used for headless frame-time regression runs.
+//   "zoom" - sweeps zoom 1.0 -> 0.5 -> 3.0 -> 0.5 -> 1.0 around varying cursor positions
+//   "pan"  - walks the player to every mountain and lake and stops on each
+//   "idle" - stands still
+// Every path ends with an INPUT_QUIT event.
+std::vector<InputEvent> buildCameraPath(const std::string& name, const World& world,
+                                        int startX, int startY,
+                                        int screenWidth, int screenHeight);
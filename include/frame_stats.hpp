@@ -0,0 +1,25 @@
+#pragma once
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Collects per-frame times and compares their percentiles to a stored baseline.
+class FrameStats {
+public:
+    void addFrame(double ms);
+
+    double percentile(double p) const;
+    size_t frameCount() const;
+
+    void report(std::ostream& out, const std::string& name) const;
+
+    // Baseline file: one "name p50 p95 p99" line per scripted path.
+    // Returns false if any percentile exceeds its baseline by more than `tolerance`
+    // (0.1 = 10%), or if `name` has no entry and allowMissing is false.
+    bool checkBaseline(const std::string& path, const std::string& name,
+                       double tolerance, bool allowMissing, std::ostream& out) const;
+    void writeBaseline(const std::string& path, const std::string& name) const;
+
+private:
+    std::vector<double> frameTimes;
+};
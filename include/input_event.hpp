@@ -0,0 +1,21 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+enum InputEventType {
+    INPUT_KEY_DOWN,
+    INPUT_MOUSE_WHEEL,
+    INPUT_QUIT,
+    INPUT_KEY_UP
+};
+
+// Minimal, replayable form of the SDL events the main loop reacts to.
+// Mouse position is captured with the event so zoom-around-cursor replays
+// identically without a real mouse.
+struct InputEvent {
+    Uint32 frame;
+    InputEventType type;
+    int key;      // SDL_Keycode for INPUT_KEY_DOWN / INPUT_KEY_UP
+    int wheelY;   // wheel direction for INPUT_MOUSE_WHEEL
+    int mouseX, mouseY;
+    Uint64 timestamp;  // performance counter when the event arrived; not recorded
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <fstream>
+#include <string>
+#include <vector>
+#include "input_event.hpp"
+
+// Writes every input event, tagged with its frame number, to a text file,
+// along with each frame's simulation timestep so a replay steps identically.
+class InputRecorder {
+public:
+    InputRecorder(const std::string& path, unsigned int seed);
+
+    void record(const InputEvent& event);
+    void recordFrameTime(Uint32 frame, double dt);
+
+private:
+    std::ofstream out;
+};
+
+// Feeds back a recorded (or scripted) event stream frame by frame.
+class InputReplay {
+public:
+    explicit InputReplay(const std::string& path);
+    InputReplay(std::vector<InputEvent> events, unsigned int seed);
+
+    // Appends all events scheduled for this frame to `out`.
+    void poll(Uint32 frame, std::vector<InputEvent>& out);
+
+    bool finished() const;
+    unsigned int getSeed() const;
+    // Recorded timestep for this frame, or `fallback` if none was recorded
+    // (scripted paths, or recordings made before frame times were logged)
+    double frameTime(Uint32 frame, double fallback) const;
+
+private:
+    std::vector<InputEvent> events;
+    std::vector<double> frameTimes;  // indexed by frame, < 0 when missing
+    size_t cursor;
+    unsigned int seed;
+};
@@ -0,0 +1,21 @@
+#pragma once
+#include "input_event.hpp"
+
+// Which arrow keys are currently held, driven by key down/up events so it
+// behaves the same for live and replayed input (no reliance on OS key repeat).
+class InputState {
+public:
+    // Returns true if the event changed the held state
+    bool apply(const InputEvent& event);
+
+    int axisX() const;  // -1 left, 1 right, 0 none/both
+    int axisY() const;  // -1 up, 1 down, 0 none/both
+
+private:
+    bool left = false;
+    bool right = false;
+    bool up = false;
+    bool down = false;
+
+    bool* slotFor(int key);
+};
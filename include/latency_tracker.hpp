@@ -0,0 +1,27 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <ostream>
+#include <vector>
+
+// Measures input-to-present latency: the time from an input event arriving
+// to the SDL_RenderPresent of the first frame that reflects it.
+class LatencyTracker {
+public:
+    // The input with this arrival timestamp changed the frame being built
+    void inputApplied(Uint64 timestamp);
+    // Call right after present; closes out every input applied this frame
+    void framePresented(Uint64 presentTime);
+
+    size_t sampleCount() const;
+    double percentile(double p) const;
+
+    // Percentiles plus a histogram in bucketMs-wide buckets
+    void report(std::ostream& out) const;
+
+private:
+    static constexpr double bucketMs = 2.0;
+    static const int bucketCount = 25;  // last bucket collects everything slower
+
+    std::vector<Uint64> pending;
+    std::vector<double> samples;
+};
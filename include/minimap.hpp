@@ -0,0 +1,30 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+#include "camera.hpp"
+
+class World;
+
+// Top-down overview of the whole world, one texture pixel per sampled tile.
+// The texture is filled a few rows per frame and then only blitted, so its
+// cost per frame is fixed no matter how many tiles the world has.
+class Minimap {
+public:
+    Minimap(SDL_Renderer* renderer, const World& world, int size);
+    ~Minimap();
+
+    // Samples at most rowBudget more rows of the minimap
+    void update(int rowBudget);
+    // Draws the minimap into dst (window coordinates) with the outline of what `view` shows
+    void render(const SDL_Rect& dst, const Viewport& view);
+
+    bool isComplete() const;
+
+private:
+    SDL_Renderer* renderer;
+    const World& world;
+    SDL_Texture* texture;
+    int size;
+    int rowsDone;
+    std::vector<Uint32> pixels;
+};
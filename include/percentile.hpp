@@ -0,0 +1,5 @@
+#pragma once
+#include <vector>
+
+// Nearest-rank percentile (p in 0..100) of `samples`; 0 when empty.
+double nearestRankPercentile(std::vector<double> samples, double p);
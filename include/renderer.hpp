@@ -4,7 +4,8 @@
 
 class Renderer {
 public:
-    Renderer(const std::string& title, int width, int height);
+    // headless: hidden window on the dummy video driver with a software renderer
+    Renderer(const std::string& title, int width, int height, bool headless = false);
     ~Renderer();
 
     void clear();
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "worker_pool.hpp"
+
+struct TilePos {
+    int x, y;
+};
+
+struct RayQuery {
+    TilePos from, to;
+};
+
+struct SightQuery {
+    TilePos from, to;
+    float eyeHeight;  // added to the ground height at both ends
+};
+
+struct RadiusQuery {
+    TilePos center;
+    int radius;
+};
+
+// Read-only terrain queries for gameplay/AI code.
+//
+// Heights are kept in a flat row-major array, walkability in a bitset, and
+// min/max heights in a pyramid of square chunks (chunkSize tiles at level 0,
+// doubling per level) so line-of-sight can reject whole regions at once.
+// All query methods are const and safe to call from several threads; the
+// batched variants split the work across a WorkerPool that is created on
+// first use and kept for the lifetime of this SpatialQuery.
+// The structures are a snapshot: rebuild after changing the terrain.
+class SpatialQuery {
+public:
+    static const int chunkSize = 16;
+
+    SpatialQuery() = default;
+    // heightMap and blocked are indexed [x][y], like World's maps
+    void build(const std::vector<std::vector<int>>& heightMap,
+               const std::vector<std::vector<bool>>& blocked);
+
+    int getWidth() const;
+    int getDepth() const;
+
+    // Out-of-bounds tiles have height 0 and are not walkable
+    int heightAt(int x, int y) const;
+    bool isWalkable(int x, int y) const;
+
+    // Heights of the tiles on the line from `from` to `to`, both ends included
+    void heightsAlongRay(TilePos from, TilePos to, std::vector<int>& out) const;
+    // Walkable tiles with squared distance <= radius^2
+    void walkableWithinRadius(TilePos center, int radius, std::vector<TilePos>& out) const;
+    // True if no tile between the two ends rises above the sight line
+    bool hasLineOfSight(TilePos from, TilePos to, float eyeHeight = 1.0f) const;
+
+    // Batched queries on at most `threads` threads (0 = whole pool). Exceptions
+    // thrown while answering a query are rethrown to the caller.
+    void heightsAlongRays(const std::vector<RayQuery>& queries,
+                          std::vector<std::vector<int>>& out, unsigned threads = 0) const;
+    void walkableWithinRadii(const std::vector<RadiusQuery>& queries,
+                             std::vector<std::vector<TilePos>>& out, unsigned threads = 0) const;
+    void lineOfSight(const std::vector<SightQuery>& queries,
+                     std::vector<uint8_t>& out, unsigned threads = 0) const;
+
+private:
+    struct MinMax {
+        int min, max;
+    };
+
+    struct Level {
+        int cellSize;           // tiles per cell side
+        int cellsX, cellsY;
+        std::vector<MinMax> cells;
+    };
+
+    int width = 0;
+    int depth = 0;
+    std::vector<int> heights;          // y * width + x
+    std::vector<uint64_t> walkable;    // bit (y * width + x)
+    std::vector<int> chunkWalkable;    // walkable tile count per level-0 chunk
+    std::vector<Level> pyramid;
+
+    mutable std::once_flag poolOnce;
+    mutable std::unique_ptr<WorkerPool> pool;
+
+    bool inBounds(int x, int y) const;
+    void runBatch(size_t count, unsigned threads, const std::function<void(size_t)>& fn) const;
+    int maxHeightIn(int x0, int y0, int x1, int y1) const;
+    bool segmentClear(TilePos from, int dx, int dy, int steps,
+                      float startH, float endH, int i0, int i1) const;
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads that stay alive between jobs, so a batched call per
+// game tick doesn't pay for creating and joining threads every time.
+// One job runs at a time; concurrent parallelFor calls are serialized.
+class WorkerPool {
+public:
+    // workers = 0 uses hardware_concurrency() - 1 (the caller also takes part)
+    explicit WorkerPool(unsigned workers = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Number of threads that can run a job, including the caller
+    unsigned threadCount() const;
+
+    // Runs fn(i) for every i in [0, count) split into `slices` contiguous
+    // ranges, on the workers and the calling thread. Returns when all are done.
+    // If fn throws, remaining slices are skipped and the first exception is
+    // rethrown here.
+    void parallelFor(size_t count, unsigned slices, const std::function<void(size_t)>& fn);
+
+private:
+    std::vector<std::thread> threads;
+
+    std::mutex submitMutex;   // one job at a time
+    std::mutex jobMutex;
+    std::condition_variable jobReady;
+    std::condition_variable jobDone;
+
+    // Current job, guarded by jobMutex
+    const std::function<void(size_t)>* job = nullptr;
+    size_t jobCount = 0;
+    unsigned jobSlices = 0;
+    unsigned nextSlice = 0;
+    unsigned slicesDone = 0;
+    unsigned long generation = 0;
+    std::exception_ptr failure;
+    bool stopping = false;
+
+    void workerLoop();
+    // Claims and runs slices of the current job until none are left
+    void runSlices(std::unique_lock<std::mutex>& lock);
+};
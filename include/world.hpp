@@ -1,18 +1,51 @@
 #pragma once
+#include <map>
 #include <vector>
+#include <utility>
 #include <SDL2/SDL.h>
 #include "tile_instance.hpp"
+#include "spatial_query.hpp"
+#include "camera.hpp"
 
 class World {
 public:
-    World(SDL_Renderer* renderer, int width, int height);
+    World(SDL_Renderer* renderer, int width, int height, unsigned int seed);
     ~World();
-    void render(int scrollX, int scrollY);
+    // Draws only the tiles visible in the viewport; sorting, lighting and
+    // per-zoom sizes are cached in the World and shared by every viewport
+    void render(const Viewport& view);
 
-    
-    float zoom = 1.0f;  // default: 100%
+    const std::vector<std::pair<int, int>>& getMountainCenters() const;
+    const std::vector<std::pair<int, int>>& getLakeCenters() const;
+
+    // Height, walkability (lakes are not walkable) and line-of-sight queries
+    const SpatialQuery& getSpatialQuery() const;
+    // Whether the tile is covered by a lake; false outside the world
+    bool isLake(int x, int y) const;
+
+    // Camera whose view of a viewW x viewH rect contains the whole world,
+    // including mountain tops and valley walls
+    Camera cameraShowingWholeWorld(int viewW, int viewH) const;
+    // Camera at `zoom` that puts the top surface of tile (gridX, gridY) in the
+    // middle of a viewW x viewH rect
+    Camera cameraCenteredOn(int gridX, int gridY, float zoom, int viewW, int viewH) const;
 
 private:
+    // Camera-independent per-tile render data, parallel to `tiles`
+    struct TileShading {
+        SDL_Texture* topTex;
+        int topBrightness;
+        int heightRight, heightUp, heightDown;
+        bool lake;
+    };
+
+    // Zoom-dependent sizes, computed once per zoom level
+    struct ZoomMetrics {
+        int scaledTileWidth, scaledTileHeight;
+        float scaledVerticalOverlap;  // fractional so walls keep their height at small zooms
+        int padAbove, padBelow;  // screen extent of walls/tops around a tile's base
+    };
+
     SDL_Renderer* renderer;
 
     SDL_Texture* grassTexture;
@@ -21,7 +54,11 @@ private:
     SDL_Texture* bushTexture;
     SDL_Texture* dirtTexture;
 
-    std::vector<TileInstance> tiles;
+    std::vector<TileInstance> tiles;  // sorted back to front by (gridX + gridY, gridX)
+    std::vector<TileShading> shading;
+    std::vector<size_t> diagonalStart;  // index in `tiles` of the first tile on each diagonal
+    std::map<float, ZoomMetrics> zoomCache;
+    int maxTileHeight, minTileHeight;
 
     int width, height;
 
@@ -33,7 +70,17 @@ private:
     std::vector<std::vector<bool>> mountainSeed;
     std::vector<std::vector<bool>> lakeSeed;
 
+    std::vector<std::pair<int, int>> mountainCenters;
+    std::vector<std::pair<int, int>> lakeCenters;
+
+    unsigned int seed;
+
+    SpatialQuery spatialQuery;
+
     void generateWorld();
+    void buildRenderCache();
+    const ZoomMetrics& metricsFor(float zoom);
+    void renderTile(const TileInstance& t, const TileShading& s, int isoX, int isoY, const ZoomMetrics& m);
     SDL_Texture* loadTexture(const char* path);
     SDL_Texture* cliffTexture;
     int getHeightAt(int x, int y);
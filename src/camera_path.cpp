@@ -0,0 +1,96 @@
+#include "camera_path.hpp"
+#include "world.hpp"
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+const Uint32 framesPerZoomStep = 3;
+const Uint32 framesPerMoveStep = 2;
+const Uint32 idleFrames = 600;
+const Uint32 settleFrames = 30;  // also how long the pan path stops at each waypoint
+
+InputEvent makeWheel(Uint32 frame, int wheelY, int mouseX, int mouseY) {
+    return { frame, INPUT_MOUSE_WHEEL, 0, wheelY, mouseX, mouseY, 0 };
+}
+
+// Press on `frame`, release on the next one: exactly one held-key step
+void pushKeyTap(std::vector<InputEvent>& events, Uint32 frame, SDL_Keycode key) {
+    events.push_back({ frame, INPUT_KEY_DOWN, key, 0, 0, 0, 0 });
+    events.push_back({ frame + 1, INPUT_KEY_UP, key, 0, 0, 0, 0 });
+}
+
+std::vector<InputEvent> buildZoomPath(int screenWidth, int screenHeight) {
+    // Zoom changes by 0.1 per wheel step between 0.5 and 3.0
+    const std::pair<int, int> sweeps[] = {
+        { -1, 5 },   // 1.0 -> 0.5
+        {  1, 25 },  // 0.5 -> 3.0
+        { -1, 25 },  // 3.0 -> 0.5
+        {  1, 5 }    // 0.5 -> 1.0
+    };
+    // The camera starts centred on the player's tile, so cursors near the middle
+    // of the view (offset down, into the world) stay over terrain at every zoom
+    const std::pair<int, int> cursors[] = {
+        { screenWidth / 2, screenHeight / 2 },
+        { screenWidth * 3 / 8, screenHeight * 5 / 8 },
+        { screenWidth * 5 / 8, screenHeight * 5 / 8 },
+        { screenWidth / 2, screenHeight * 9 / 16 }
+    };
+
+    std::vector<InputEvent> events;
+    Uint32 frame = 0;
+    int cursor = 0;
+    for (const auto& [direction, steps] : sweeps) {
+        const auto& [mouseX, mouseY] = cursors[cursor++ % 4];
+        for (int i = 0; i < steps; ++i) {
+            frame += framesPerZoomStep;
+            events.push_back(makeWheel(frame, direction, mouseX, mouseY));
+        }
+    }
+
+    events.push_back({ frame + settleFrames, INPUT_QUIT, 0, 0, 0, 0, 0 });
+    return events;
+}
+
+std::vector<InputEvent> buildPanPath(const World& world, int startX, int startY) {
+    std::vector<std::pair<int, int>> waypoints = world.getMountainCenters();
+    const auto& lakes = world.getLakeCenters();
+    waypoints.insert(waypoints.end(), lakes.begin(), lakes.end());
+
+    std::vector<InputEvent> events;
+    Uint32 frame = 0;
+    int x = startX;
+    int y = startY;
+    for (const auto& [targetX, targetY] : waypoints) {
+        while (x != targetX) {
+            frame += framesPerMoveStep;
+            pushKeyTap(events, frame, x < targetX ? SDLK_RIGHT : SDLK_LEFT);
+            x += x < targetX ? 1 : -1;
+        }
+        while (y != targetY) {
+            frame += framesPerMoveStep;
+            pushKeyTap(events, frame, y < targetY ? SDLK_DOWN : SDLK_UP);
+            y += y < targetY ? 1 : -1;
+        }
+        // Let the camera catch up so the feature itself is timed, not just the walk there
+        frame += settleFrames;
+    }
+
+    events.push_back({ frame + settleFrames, INPUT_QUIT, 0, 0, 0, 0, 0 });
+    return events;
+}
+
+} // namespace
+
+std::vector<InputEvent> buildCameraPath(const std::string& name, const World& world,
+                                        int startX, int startY,
+                                        int screenWidth, int screenHeight) {
+    if (name == "zoom")
+        return buildZoomPath(screenWidth, screenHeight);
+    if (name == "pan")
+        return buildPanPath(world, startX, startY);
+    if (name == "idle")
+        return { { idleFrames, INPUT_QUIT, 0, 0, 0, 0, 0 } };
+
+    throw std::runtime_error("Unknown camera path: " + name);
+}
@@ -0,0 +1,86 @@
+#include "frame_stats.hpp"
+#include "percentile.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+const double percentiles[] = { 50.0, 95.0, 99.0 };
+
+} // namespace
+
+void FrameStats::addFrame(double ms) {
+    frameTimes.push_back(ms);
+}
+
+double FrameStats::percentile(double p) const {
+    return nearestRankPercentile(frameTimes, p);
+}
+
+size_t FrameStats::frameCount() const {
+    return frameTimes.size();
+}
+
+void FrameStats::report(std::ostream& out, const std::string& name) const {
+    out << name << ": " << frameCount() << " frames"
+        << "  p50=" << percentile(50.0) << "ms"
+        << "  p95=" << percentile(95.0) << "ms"
+        << "  p99=" << percentile(99.0) << "ms\n";
+}
+
+bool FrameStats::checkBaseline(const std::string& path, const std::string& name,
+                               double tolerance, bool allowMissing, std::ostream& out) const {
+    std::ifstream in(path);
+    if (!in)
+        throw std::runtime_error("Failed to open frame-time baseline: " + path);
+
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string entry;
+        double limits[3];
+        if (!(fields >> entry >> limits[0] >> limits[1] >> limits[2]) || entry != name)
+            continue;
+
+        bool passed = true;
+        for (int i = 0; i < 3; ++i) {
+            double measured = percentile(percentiles[i]);
+            double allowed = limits[i] * (1.0 + tolerance);
+            if (measured > allowed) {
+                out << name << ": p" << percentiles[i] << " " << measured
+                    << "ms exceeds baseline " << limits[i] << "ms (allowed " << allowed << "ms)\n";
+                passed = false;
+            }
+        }
+        return passed;
+    }
+
+    if (allowMissing) {
+        out << name << ": no baseline entry in " << path << ", skipping check\n";
+        return true;
+    }
+    out << name << ": no baseline entry in " << path << "\n";
+    return false;
+}
+
+void FrameStats::writeBaseline(const std::string& path, const std::string& name) const {
+    // Keep entries for other paths, replace this one
+    std::vector<std::string> kept;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string entry;
+        if (fields >> entry && entry != name)
+            kept.push_back(line);
+    }
+    in.close();
+
+    std::ofstream out(path);
+    if (!out)
+        throw std::runtime_error("Failed to write frame-time baseline: " + path);
+    for (const auto& l : kept)
+        out << l << "\n";
+    out << name << " " << percentile(50.0) << " " << percentile(95.0) << " " << percentile(99.0) << "\n";
+}
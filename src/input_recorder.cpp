@@ -0,0 +1,93 @@
+#include "input_recorder.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+// File format: a "seed N" header followed by one event per line:
+//   frame type key wheelY mouseX mouseY
+// interleaved with one timestep line per frame:
+//   dt frame seconds
+
+InputRecorder::InputRecorder(const std::string& path, unsigned int seed)
+    : out(path) {
+    if (!out)
+        throw std::runtime_error("Failed to open input recording: " + path);
+    out << "seed " << seed << "\n";
+    // Frame times must round-trip exactly for the replay to step identically
+    out << std::setprecision(std::numeric_limits<double>::max_digits10);
+}
+
+void InputRecorder::record(const InputEvent& e) {
+    out << e.frame << " " << e.type << " " << e.key << " "
+        << e.wheelY << " " << e.mouseX << " " << e.mouseY << "\n";
+}
+
+void InputRecorder::recordFrameTime(Uint32 frame, double dt) {
+    out << "dt " << frame << " " << dt << "\n";
+}
+
+InputReplay::InputReplay(const std::string& path)
+    : cursor(0), seed(0) {
+    std::ifstream in(path);
+    if (!in)
+        throw std::runtime_error("Failed to open input replay: " + path);
+
+    std::string tag;
+    if (!(in >> tag >> seed) || tag != "seed")
+        throw std::runtime_error("Input replay is missing its seed header: " + path);
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty())
+            continue;
+
+        std::istringstream fields(line);
+        if (line.compare(0, 3, "dt ") == 0) {
+            std::string dtTag;
+            Uint32 frame;
+            double dt;
+            if (!(fields >> dtTag >> frame >> dt))
+                throw std::runtime_error("Malformed input replay line: " + line);
+            if (frame >= frameTimes.size())
+                frameTimes.resize(frame + 1, -1.0);
+            frameTimes[frame] = dt;
+            continue;
+        }
+
+        InputEvent e{};
+        int type;
+        if (!(fields >> e.frame >> type >> e.key >> e.wheelY >> e.mouseX >> e.mouseY))
+            throw std::runtime_error("Malformed input replay line: " + line);
+        e.type = static_cast<InputEventType>(type);
+        events.push_back(e);
+    }
+}
+
+InputReplay::InputReplay(std::vector<InputEvent> events, unsigned int seed)
+    : events(std::move(events)), cursor(0), seed(seed) {
+    std::stable_sort(this->events.begin(), this->events.end(),
+                     [](const InputEvent& a, const InputEvent& b) { return a.frame < b.frame; });
+}
+
+void InputReplay::poll(Uint32 frame, std::vector<InputEvent>& out) {
+    while (cursor < events.size() && events[cursor].frame <= frame) {
+        out.push_back(events[cursor]);
+        ++cursor;
+    }
+}
+
+double InputReplay::frameTime(Uint32 frame, double fallback) const {
+    if (frame < frameTimes.size() && frameTimes[frame] >= 0.0)
+        return frameTimes[frame];
+    return fallback;
+}
+
+bool InputReplay::finished() const {
+    return cursor >= events.size();
+}
+
+unsigned int InputReplay::getSeed() const {
+    return seed;
+}
@@ -0,0 +1,34 @@
+#include "input_state.hpp"
+
+bool InputState::apply(const InputEvent& event) {
+    if (event.type != INPUT_KEY_DOWN && event.type != INPUT_KEY_UP)
+        return false;
+
+    bool* slot = slotFor(event.key);
+    if (!slot)
+        return false;
+
+    bool held = event.type == INPUT_KEY_DOWN;
+    if (*slot == held)
+        return false;
+    *slot = held;
+    return true;
+}
+
+int InputState::axisX() const {
+    return int(right) - int(left);
+}
+
+int InputState::axisY() const {
+    return int(down) - int(up);
+}
+
+bool* InputState::slotFor(int key) {
+    switch (key) {
+        case SDLK_LEFT:  return &left;
+        case SDLK_RIGHT: return &right;
+        case SDLK_UP:    return &up;
+        case SDLK_DOWN:  return &down;
+    }
+    return nullptr;
+}
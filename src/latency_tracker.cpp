@@ -0,0 +1,54 @@
+#include "latency_tracker.hpp"
+#include "percentile.hpp"
+#include <algorithm>
+#include <string>
+
+void LatencyTracker::inputApplied(Uint64 timestamp) {
+    pending.push_back(timestamp);
+}
+
+void LatencyTracker::framePresented(Uint64 presentTime) {
+    double ticksPerMs = SDL_GetPerformanceFrequency() / 1000.0;
+    for (Uint64 timestamp : pending) {
+        Uint64 elapsed = presentTime > timestamp ? presentTime - timestamp : 0;
+        samples.push_back(elapsed / ticksPerMs);
+    }
+    pending.clear();
+}
+
+size_t LatencyTracker::sampleCount() const {
+    return samples.size();
+}
+
+double LatencyTracker::percentile(double p) const {
+    return nearestRankPercentile(samples, p);
+}
+
+void LatencyTracker::report(std::ostream& out) const {
+    out << "input-to-present: " << sampleCount() << " inputs"
+        << "  p50=" << percentile(50.0) << "ms"
+        << "  p95=" << percentile(95.0) << "ms"
+        << "  p99=" << percentile(99.0) << "ms"
+        << "  max=" << percentile(100.0) << "ms\n";
+
+    if (samples.empty())
+        return;
+
+    std::vector<size_t> buckets(bucketCount, 0);
+    for (double ms : samples)
+        ++buckets[std::min(bucketCount - 1, int(ms / bucketMs))];
+
+    size_t largest = *std::max_element(buckets.begin(), buckets.end());
+    const int barWidth = 40;
+    for (int i = 0; i < bucketCount; ++i) {
+        if (buckets[i] == 0)
+            continue;
+
+        if (i == bucketCount - 1)
+            out << "  >=" << i * bucketMs << "ms";
+        else
+            out << "  " << i * bucketMs << "-" << (i + 1) * bucketMs << "ms";
+        out << "\t" << buckets[i] << "\t"
+            << std::string(buckets[i] * barWidth / largest, '#') << "\n";
+    }
+}
@@ -1,16 +1,128 @@
 #include "renderer.hpp"
 #include "world.hpp"
 #include "player.hpp"
+#include "input_event.hpp"
+#include "input_recorder.hpp"
+#include "camera_path.hpp"
+#include "frame_stats.hpp"
+#include "input_state.hpp"
+#include "latency_tracker.hpp"
+#include "camera.hpp"
+#include "minimap.hpp"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
-int main() {
+// Command line:
+//   --seed N             fixed world seed (default: random)
+//   --record FILE        record input events to FILE
+//   --replay FILE        replay input events from FILE (uses its recorded seed)
+//   --path NAME          run a scripted camera path: zoom, pan or idle
+//   --headless           no visible window, software rendering
+//   --baseline FILE      fail if p50/p95/p99 frame times exceed FILE's entry
+//   --tolerance X        allowed overshoot over the baseline (default 0.1 = 10%)
+//   --write-baseline     store this run's percentiles in the baseline file (needs --baseline)
+//   --allow-missing-baseline  pass when the baseline has no entry for this run
+//   --latency            print an input-to-present latency histogram on exit
+//   --split              split the window: player view left, whole-world overview right
+struct Options {
+    bool hasSeed = false;
+    unsigned int seed = 0;
+    std::string recordPath;
+    std::string replayPath;
+    std::string cameraPath;
+    bool headless = false;
+    std::string baselinePath;
+    double tolerance = 0.1;
+    bool writeBaseline = false;
+    bool allowMissingBaseline = false;
+    bool reportLatency = false;
+    bool splitScreen = false;
+};
+
+static Options parseOptions(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc)
+                throw std::runtime_error("Missing value for " + arg);
+            return argv[++i];
+        };
+
+        if (arg == "--seed") {
+            options.hasSeed = true;
+            options.seed = std::stoul(value());
+        } else if (arg == "--record") {
+            options.recordPath = value();
+        } else if (arg == "--replay") {
+            options.replayPath = value();
+        } else if (arg == "--path") {
+            options.cameraPath = value();
+        } else if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--baseline") {
+            options.baselinePath = value();
+        } else if (arg == "--tolerance") {
+            options.tolerance = std::stod(value());
+        } else if (arg == "--write-baseline") {
+            options.writeBaseline = true;
+        } else if (arg == "--allow-missing-baseline") {
+            options.allowMissingBaseline = true;
+        } else if (arg == "--latency") {
+            options.reportLatency = true;
+        } else if (arg == "--split") {
+            options.splitScreen = true;
+        } else {
+            throw std::runtime_error("Unknown option: " + arg);
+        }
+    }
+
+    if (!options.replayPath.empty() && !options.cameraPath.empty())
+        throw std::runtime_error("--replay and --path are mutually exclusive");
+    if (options.writeBaseline && options.baselinePath.empty())
+        throw std::runtime_error("--write-baseline needs --baseline FILE");
+    if (!options.baselinePath.empty() && options.replayPath.empty() && options.cameraPath.empty())
+        throw std::runtime_error("--baseline needs --replay or --path");
+    return options;
+}
+
+// Performance-counter time at which SDL queued the event, so time spent
+// waiting in the event queue counts towards input latency
+static Uint64 arrivalTime(const SDL_Event& event) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint32 queuedMs = SDL_GetTicks() - event.common.timestamp;
+    Uint64 queuedTicks = Uint64(queuedMs) * SDL_GetPerformanceFrequency() / 1000;
+    return queuedTicks < now ? now - queuedTicks : now;
+}
+
+int main(int argc, char* argv[]) {
     try {
+        Options options = parseOptions(argc, argv);
+
+        std::unique_ptr<InputReplay> replay;
+        if (!options.replayPath.empty())
+            replay = std::make_unique<InputReplay>(options.replayPath);
+
+        // SDL isn't initialised yet, so SDL_GetTicks() would be ~0 on every launch
+        unsigned int seed = options.hasSeed ? options.seed : std::random_device{}();
+        if (!options.cameraPath.empty() && !options.hasSeed)
+            seed = 1;  // scripted paths must see the same terrain every run
+        if (replay)
+            seed = replay->getSeed();
+
         // Create renderer + SDL
-        Renderer renderer("2.5D Pixel World", 640, 480);
+        Renderer renderer("2.5D Pixel World", 640, 480, options.headless);
         SDL_Renderer* sdlRenderer = renderer.getRenderer();
-        World world(sdlRenderer, 50, 50);
+        const int worldWidth = 50;
+        const int worldHeight = 50;
+        World world(sdlRenderer, worldWidth, worldHeight, seed);
 
         // Load player (uses 64x64 sprite frames)
         Player player(sdlRenderer, "../assets/archer_blond_hair.png", 64, 64);
@@ -19,73 +131,206 @@ int main() {
         int playerGridX = 5;
         int playerGridY = 5;
 
-        // Tile size and screen center
-        const int tileSize = 32;
         const int screenWidth = 640;
         const int screenHeight = 480;
-        const int playerScreenX = screenWidth / 2 - 32; // 64px sprite
-        const int playerScreenY = screenHeight / 2 - 32;
 
-        // Camera scroll values
-        int scrollX = playerGridX * tileSize;
-        int scrollY = playerGridY * tileSize - playerGridX * 8;
+        // Player view, plus an optional overview sharing the same world caches
+        Viewport playerView = { { 0, 0, options.splitScreen ? screenWidth / 2 : screenWidth, screenHeight }, {} };
+        Viewport overview = { { screenWidth / 2, 0, screenWidth / 2, screenHeight }, {} };
+        overview.camera = world.cameraShowingWholeWorld(overview.rect.w, overview.rect.h);
+
+        const int playerScreenX = playerView.rect.x + playerView.rect.w / 2 - 32; // 64px sprite
+        const int playerScreenY = playerView.rect.y + playerView.rect.h / 2 - 32;
+
+        // Minimap is sampled a few rows per frame, then just blitted
+        const int minimapSize = 120;
+        const int minimapRowsPerFrame = 8;
+        // Top-right of the player view, so it never covers the --split overview
+        const SDL_Rect minimapRect = { playerView.rect.x + playerView.rect.w - minimapSize - 8,
+                                       playerView.rect.y + 8, minimapSize, minimapSize };
+        Minimap minimap(sdlRenderer, world, minimapSize);
+
+        if (!options.cameraPath.empty()) {
+            replay = std::make_unique<InputReplay>(
+                buildCameraPath(options.cameraPath, world, playerGridX, playerGridY,
+                                screenWidth, screenHeight),
+                seed);
+        }
+
+        std::unique_ptr<InputRecorder> recorder;
+        if (!options.recordPath.empty())
+            recorder = std::make_unique<InputRecorder>(options.recordPath, seed);
+
+        // Camera follows this target smoothly; zooming re-targets to where the camera is
+        Camera& camera = playerView.camera;
+        camera = world.cameraCenteredOn(playerGridX, playerGridY, camera.zoom,
+                                        playerView.rect.w, playerView.rect.h);
+        float cameraX = camera.scrollX;
+        float cameraY = camera.scrollY;
+        float targetX = cameraX;
+        float targetY = cameraY;
 
         SDL_Event event;
         bool running = true;
         const int moveSpeed = 1;
+        const double moveIntervalSec = 0.15;   // held-key step rate
+        const double cameraFollowRate = 12.0;  // higher = snappier camera
+        const double replayFrameDt = 1.0 / 60.0;
+        double moveTimer = 0.0;
+
+        FrameStats frameStats;
+        LatencyTracker latency;
+        InputState heldKeys;
+        std::vector<InputEvent> frameEvents;
+        Uint32 frame = 0;
+        Uint64 lastFrameStart = SDL_GetPerformanceCounter();
 
         while (running) {
-            int dx = 0, dy = 0;
-            player.setMoving(false);  // Assume idle
+            Uint64 frameStart = SDL_GetPerformanceCounter();
+            // Replays advance by the timestep recorded for each frame (or a fixed
+            // one for scripted paths), not wall clock, so they render the same
+            // path at any frame rate
+            double dt = replay ? replay->frameTime(frame, replayFrameDt)
+                               : double(frameStart - lastFrameStart) / SDL_GetPerformanceFrequency();
+            lastFrameStart = frameStart;
+            if (recorder)
+                recorder->recordFrameTime(frame, dt);
 
+            frameEvents.clear();
             while (SDL_PollEvent(&event)) {
+                Uint64 arrived = arrivalTime(event);
                 if (event.type == SDL_QUIT)
-                    running = false;
+                    frameEvents.push_back({ frame, INPUT_QUIT, 0, 0, 0, 0, arrived });
+                else if (replay)
+                    continue;  // live input is ignored while replaying
                 else if (event.type == SDL_MOUSEWHEEL) {
                     int mouseX, mouseY;
                     SDL_GetMouseState(&mouseX, &mouseY);
+                    frameEvents.push_back({ frame, INPUT_MOUSE_WHEEL, 0, event.wheel.y, mouseX, mouseY, arrived });
+                }
+                else if ((event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) && !event.key.repeat) {
+                    InputEventType type = event.type == SDL_KEYDOWN ? INPUT_KEY_DOWN : INPUT_KEY_UP;
+                    frameEvents.push_back({ frame, type, event.key.keysym.sym, 0, 0, 0, arrived });
+                }
+            }
 
-                    float oldZoom = world.zoom;
+            if (replay) {
+                size_t live = frameEvents.size();
+                replay->poll(frame, frameEvents);
+                for (size_t i = live; i < frameEvents.size(); ++i)
+                    frameEvents[i].timestamp = frameStart;
+                if (replay->finished() && frameEvents.empty())
+                    running = false;
+            }
+
+            bool stepNow = false;
+            for (const InputEvent& input : frameEvents) {
+                if (recorder)
+                    recorder->record(input);
+
+                if (input.type == INPUT_QUIT)
+                    running = false;
+                else if (input.type == INPUT_MOUSE_WHEEL) {
+                    int mouseX = input.mouseX - playerView.rect.x;
+                    int mouseY = input.mouseY - playerView.rect.y;
+
+                    float oldZoom = camera.zoom;
 
-                    if (event.wheel.y > 0) {
-                        world.zoom = std::min(world.zoom + 0.1f, 3.0f);
-                    } else if (event.wheel.y < 0) {
-                        world.zoom = std::max(world.zoom - 0.1f, 0.5f);
+                    if (input.wheelY > 0) {
+                        camera.zoom = std::min(camera.zoom + 0.1f, 3.0f);
+                    } else if (input.wheelY < 0) {
+                        camera.zoom = std::max(camera.zoom - 0.1f, 0.5f);
                     }
 
-                    // Adjust scroll to zoom around cursor
-                    float zoomRatio = world.zoom / oldZoom;
-                    scrollX = (scrollX + mouseX) * zoomRatio - mouseX;
-                    scrollY = (scrollY + mouseY) * zoomRatio - mouseY;
+                    if (camera.zoom != oldZoom) {
+                        // Zoom around cursor: keep the unzoomed world point under it fixed
+                        cameraX += mouseX / oldZoom - mouseX / camera.zoom;
+                        cameraY += mouseY / oldZoom - mouseY / camera.zoom;
+                        targetX = cameraX;
+                        targetY = cameraY;
+                        latency.inputApplied(input.timestamp);
+                    }
+                }
+                else if (heldKeys.apply(input)) {
+                    // A fresh press steps immediately instead of waiting for the repeat interval
+                    if (input.type == INPUT_KEY_DOWN)
+                        stepNow = true;
+                    latency.inputApplied(input.timestamp);
                 }
+            }
 
-                else if (event.type == SDL_KEYDOWN) {
-                    switch (event.key.keysym.sym) {
-                        case SDLK_LEFT:  dx = -1; break;
-                        case SDLK_RIGHT: dx = 1;  break;
-                        case SDLK_UP:    dy = -1; break;
-                        case SDLK_DOWN:  dy = 1;  break;
-                    }
+            int dx = heldKeys.axisX() * moveSpeed;
+            int dy = heldKeys.axisY() * moveSpeed;
+            bool moving = dx != 0 || dy != 0;
+            player.setMoving(moving);
 
-                    if (dx != 0 || dy != 0) {
-                        player.setMoving(true);  // Moving!
-                        player.setDirection(dx, dy);
+            if (moving) {
+                moveTimer -= dt;
+                if (stepNow || moveTimer <= 0.0) {
+                    moveTimer = stepNow ? moveIntervalSec : std::max(moveTimer + moveIntervalSec, 0.0);
 
-                        playerGridX += dx;
-                        playerGridY += dy;
+                    player.setDirection(dx, dy);
+                    playerGridX += dx;
+                    playerGridY += dy;
 
-                        scrollX = playerGridX * 32;
-                        scrollY = playerGridY * 32 - playerGridX * 8;
-                    }
+                    // Keep the player's tile under the sprite drawn in the middle of the view
+                    Camera onPlayer = world.cameraCenteredOn(playerGridX, playerGridY, camera.zoom,
+                                                             playerView.rect.w, playerView.rect.h);
+                    targetX = onPlayer.scrollX;
+                    targetY = onPlayer.scrollY;
                 }
             }
 
+            // Frame-rate independent exponential follow
+            float follow = float(1.0 - std::exp(-cameraFollowRate * dt));
+            cameraX += (targetX - cameraX) * follow;
+            cameraY += (targetY - cameraY) * follow;
+            camera.scrollX = std::round(cameraX);
+            camera.scrollY = std::round(cameraY);
+
+            minimap.update(minimapRowsPerFrame);
+
             player.update();
 
             renderer.clear();
-            world.render(scrollX, scrollY);
+            world.render(playerView);
+            if (options.splitScreen)
+                world.render(overview);
             player.render(sdlRenderer, playerScreenX, playerScreenY);
+            minimap.render(minimapRect, playerView);
             renderer.present();
+
+            Uint64 frameEnd = SDL_GetPerformanceCounter();
+            latency.framePresented(frameEnd);
+            if (replay)  // only replays report frame times; don't grow this during live play
+                frameStats.addFrame((frameEnd - frameStart) * 1000.0 / SDL_GetPerformanceFrequency());
+            ++frame;
+        }
+
+        if (options.reportLatency)
+            latency.report(std::cout);
+
+        if (replay) {
+            std::string runName = options.cameraPath.empty() ? options.replayPath : options.cameraPath;
+
+            // Closing the window mid-replay leaves a partial run: never gate on it or store it
+            if (!replay->finished()) {
+                std::cout << runName << ": replay interrupted after " << frame
+                          << " frames, frame times not checked\n";
+                return 1;
+            }
+
+            frameStats.report(std::cout, runName);
+
+            if (!options.baselinePath.empty()) {
+                if (options.writeBaseline) {
+                    frameStats.writeBaseline(options.baselinePath, runName);
+                } else if (!frameStats.checkBaseline(options.baselinePath, runName,
+                                                     options.tolerance, options.allowMissingBaseline,
+                                                     std::cout)) {
+                    return 1;
+                }
+            }
         }
 
 
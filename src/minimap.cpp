@@ -0,0 +1,95 @@
+#include "minimap.hpp"
+#include "world.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+Uint32 packRGBA(int r, int g, int b) {
+    return (Uint32(r) << 24) | (Uint32(g) << 16) | (Uint32(b) << 8) | 0xFF;
+}
+
+} // namespace
+
+Minimap::Minimap(SDL_Renderer* renderer, const World& world, int size)
+    : renderer(renderer), world(world), texture(nullptr), size(size), rowsDone(0),
+      pixels(size_t(size) * size, packRGBA(0, 0, 0)) {
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                                SDL_TEXTUREACCESS_STREAMING, size, size);
+    if (!texture)
+        throw std::runtime_error("Failed to create minimap texture");
+    SDL_SetTextureScaleMode(texture, SDL_ScaleModeNearest);
+    SDL_UpdateTexture(texture, nullptr, pixels.data(), size * sizeof(Uint32));
+}
+
+Minimap::~Minimap() {
+    SDL_DestroyTexture(texture);
+}
+
+void Minimap::update(int rowBudget) {
+    if (isComplete())
+        return;
+
+    const SpatialQuery& terrain = world.getSpatialQuery();
+    int worldW = terrain.getWidth();
+    int worldD = terrain.getDepth();
+
+    int firstRow = rowsDone;
+    int lastRow = std::min(size, rowsDone + rowBudget);
+    for (int py = firstRow; py < lastRow; ++py) {
+        int ty = py * worldD / size;
+        for (int px = 0; px < size; ++px) {
+            int tx = px * worldW / size;
+            int h = terrain.heightAt(tx, ty);
+
+            Uint32 color;
+            if (world.isLake(tx, ty)) {
+                color = packRGBA(40, 90, 200);  // lake
+            } else {
+                // Same height shading as the top surfaces in World::render
+                int brightness = std::clamp(180 + h * 20, 40, 255);
+                color = packRGBA(brightness / 3, brightness, brightness / 4);
+            }
+            pixels[size_t(py) * size + px] = color;
+        }
+    }
+
+    SDL_Rect rows = { 0, firstRow, size, lastRow - firstRow };
+    SDL_UpdateTexture(texture, &rows, &pixels[size_t(firstRow) * size], size * sizeof(Uint32));
+    rowsDone = lastRow;
+}
+
+void Minimap::render(const SDL_Rect& dst, const Viewport& view) {
+    SDL_RenderCopy(renderer, texture, nullptr, &dst);
+
+    const SpatialQuery& terrain = world.getSpatialQuery();
+    int worldW = terrain.getWidth();
+    int worldD = terrain.getDepth();
+    if (worldW == 0 || worldD == 0)
+        return;
+
+    // The view's screen corners, projected back onto the grid, form a diamond
+    const Camera& cam = view.camera;
+    const int corners[5][2] = {
+        { 0, 0 }, { view.rect.w, 0 }, { view.rect.w, view.rect.h }, { 0, view.rect.h }, { 0, 0 }
+    };
+    SDL_Point outline[5];
+    for (int i = 0; i < 5; ++i) {
+        float isoX = cam.scrollX + corners[i][0] / cam.zoom;
+        float isoY = cam.scrollY + corners[i][1] / cam.zoom;
+        float gridX = (isoX / 32.0f + isoY / 16.0f) / 2.0f;
+        float gridY = (isoY / 16.0f - isoX / 32.0f) / 2.0f;
+        outline[i] = { dst.x + int(gridX * dst.w / worldW), dst.y + int(gridY * dst.h / worldD) };
+    }
+
+    SDL_RenderSetClipRect(renderer, &dst);
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderDrawLines(renderer, outline, 5);
+    SDL_RenderSetClipRect(renderer, nullptr);
+    SDL_RenderDrawRect(renderer, &dst);
+}
+
+bool Minimap::isComplete() const {
+    return rowsDone >= size;
+}
@@ -0,0 +1,14 @@
+#include "percentile.hpp"
+#include <algorithm>
+#include <cmath>
+
+double nearestRankPercentile(std::vector<double> samples, double p) {
+    if (samples.empty())
+        return 0.0;
+
+    std::sort(samples.begin(), samples.end());
+
+    size_t rank = size_t(std::ceil(p / 100.0 * samples.size()));
+    rank = std::clamp<size_t>(rank, 1, samples.size());
+    return samples[rank - 1];
+}
@@ -2,9 +2,12 @@
 #include <SDL2/SDL_image.h>
 #include <stdexcept>
 
-Renderer::Renderer(const std::string& title, int width, int height)
+Renderer::Renderer(const std::string& title, int width, int height, bool headless)
     : window(nullptr), renderer(nullptr), width(width), height(height) {
 
+    if (headless)
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+
     if (SDL_Init(SDL_INIT_VIDEO) < 0)
         throw std::runtime_error("Failed to initialize SDL2");
 
@@ -14,11 +17,13 @@ Renderer::Renderer(const std::string& title, int width, int height)
     window = SDL_CreateWindow(title.c_str(),
                               SDL_WINDOWPOS_CENTERED,
                               SDL_WINDOWPOS_CENTERED,
-                              width, height, 0);
+                              width, height,
+                              headless ? SDL_WINDOW_HIDDEN : 0);
     if (!window)
         throw std::runtime_error("Failed to create SDL window");
 
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    renderer = SDL_CreateRenderer(window, -1,
+                                  headless ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED);
     if (!renderer)
         throw std::runtime_error("Failed to create SDL renderer");
 }
@@ -0,0 +1,272 @@
+#include "spatial_query.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+// Below this many queries per thread, waking workers costs more than it saves
+const size_t minQueriesPerThread = 64;
+
+// Tile i of n steps along a line, rounded to the nearest tile
+TilePos pointOnLine(TilePos from, int dx, int dy, int steps, int i) {
+    if (steps == 0)
+        return from;
+    return { from.x + int(std::lround(double(dx) * i / steps)),
+             from.y + int(std::lround(double(dy) * i / steps)) };
+}
+
+} // namespace
+
+void SpatialQuery::build(const std::vector<std::vector<int>>& heightMap,
+                         const std::vector<std::vector<bool>>& blocked) {
+    width = int(heightMap.size());
+    depth = width > 0 ? int(heightMap[0].size()) : 0;
+
+    pyramid.clear();
+    if (width == 0 || depth == 0) {
+        // Leave everything empty so queries see an empty world
+        width = 0;
+        depth = 0;
+        heights.clear();
+        walkable.clear();
+        chunkWalkable.clear();
+        return;
+    }
+
+    heights.assign(size_t(width) * depth, 0);
+    walkable.assign((size_t(width) * depth + 63) / 64, 0);
+    for (int y = 0; y < depth; ++y) {
+        for (int x = 0; x < width; ++x) {
+            size_t i = size_t(y) * width + x;
+            heights[i] = heightMap[x][y];
+            if (!blocked[x][y])
+                walkable[i / 64] |= uint64_t(1) << (i % 64);
+        }
+    }
+
+    // Level 0: one cell per chunk, built from tiles
+    Level base;
+    base.cellSize = chunkSize;
+    base.cellsX = (width + chunkSize - 1) / chunkSize;
+    base.cellsY = (depth + chunkSize - 1) / chunkSize;
+    base.cells.assign(size_t(base.cellsX) * base.cellsY, { 0, 0 });
+    chunkWalkable.assign(base.cells.size(), 0);
+
+    for (int cy = 0; cy < base.cellsY; ++cy) {
+        for (int cx = 0; cx < base.cellsX; ++cx) {
+            size_t c = size_t(cy) * base.cellsX + cx;
+            MinMax& mm = base.cells[c];
+            mm = { heightAt(cx * chunkSize, cy * chunkSize), heightAt(cx * chunkSize, cy * chunkSize) };
+
+            int xEnd = std::min(width, (cx + 1) * chunkSize);
+            int yEnd = std::min(depth, (cy + 1) * chunkSize);
+            for (int y = cy * chunkSize; y < yEnd; ++y) {
+                for (int x = cx * chunkSize; x < xEnd; ++x) {
+                    int h = heights[size_t(y) * width + x];
+                    mm.min = std::min(mm.min, h);
+                    mm.max = std::max(mm.max, h);
+                    if (isWalkable(x, y))
+                        ++chunkWalkable[c];
+                }
+            }
+        }
+    }
+    pyramid.push_back(std::move(base));
+
+    // Higher levels: each cell merges a 2x2 block of the level below
+    while (pyramid.back().cellsX > 1 || pyramid.back().cellsY > 1) {
+        const Level& below = pyramid.back();
+        Level next;
+        next.cellSize = below.cellSize * 2;
+        next.cellsX = (below.cellsX + 1) / 2;
+        next.cellsY = (below.cellsY + 1) / 2;
+        next.cells.resize(size_t(next.cellsX) * next.cellsY);
+
+        for (int cy = 0; cy < next.cellsY; ++cy) {
+            for (int cx = 0; cx < next.cellsX; ++cx) {
+                MinMax mm = below.cells[size_t(cy * 2) * below.cellsX + cx * 2];
+                for (auto [ox, oy] : { std::pair{1, 0}, {0, 1}, {1, 1} }) {
+                    int bx = cx * 2 + ox;
+                    int by = cy * 2 + oy;
+                    if (bx >= below.cellsX || by >= below.cellsY)
+                        continue;
+                    const MinMax& other = below.cells[size_t(by) * below.cellsX + bx];
+                    mm.min = std::min(mm.min, other.min);
+                    mm.max = std::max(mm.max, other.max);
+                }
+                next.cells[size_t(cy) * next.cellsX + cx] = mm;
+            }
+        }
+        pyramid.push_back(std::move(next));
+    }
+}
+
+int SpatialQuery::getWidth() const {
+    return width;
+}
+
+int SpatialQuery::getDepth() const {
+    return depth;
+}
+
+bool SpatialQuery::inBounds(int x, int y) const {
+    return x >= 0 && x < width && y >= 0 && y < depth;
+}
+
+int SpatialQuery::heightAt(int x, int y) const {
+    if (!inBounds(x, y))
+        return 0;
+    return heights[size_t(y) * width + x];
+}
+
+bool SpatialQuery::isWalkable(int x, int y) const {
+    if (!inBounds(x, y))
+        return false;
+    size_t i = size_t(y) * width + x;
+    return (walkable[i / 64] >> (i % 64)) & 1;
+}
+
+void SpatialQuery::heightsAlongRay(TilePos from, TilePos to, std::vector<int>& out) const {
+    int dx = to.x - from.x;
+    int dy = to.y - from.y;
+    int steps = std::max(std::abs(dx), std::abs(dy));
+
+    out.clear();
+    out.reserve(steps + 1);
+    for (int i = 0; i <= steps; ++i) {
+        TilePos p = pointOnLine(from, dx, dy, steps, i);
+        out.push_back(heightAt(p.x, p.y));
+    }
+}
+
+void SpatialQuery::walkableWithinRadius(TilePos center, int radius, std::vector<TilePos>& out) const {
+    out.clear();
+    if (radius < 0 || pyramid.empty())
+        return;
+
+    // 64-bit so huge radii on large worlds neither overflow the box nor the distances
+    int x0 = int(std::max<int64_t>(0, int64_t(center.x) - radius));
+    int y0 = int(std::max<int64_t>(0, int64_t(center.y) - radius));
+    int x1 = int(std::min<int64_t>(width - 1, int64_t(center.x) + radius));
+    int y1 = int(std::min<int64_t>(depth - 1, int64_t(center.y) + radius));
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    const Level& chunks = pyramid[0];
+    int64_t radiusSq = int64_t(radius) * radius;
+
+    for (int cy = y0 / chunkSize; cy <= y1 / chunkSize; ++cy) {
+        for (int cx = x0 / chunkSize; cx <= x1 / chunkSize; ++cx) {
+            if (chunkWalkable[size_t(cy) * chunks.cellsX + cx] == 0)
+                continue;  // nothing walkable in this chunk
+
+            int yStart = std::max(y0, cy * chunkSize);
+            int yEnd = std::min(y1, (cy + 1) * chunkSize - 1);
+            int xStart = std::max(x0, cx * chunkSize);
+            int xEnd = std::min(x1, (cx + 1) * chunkSize - 1);
+            for (int y = yStart; y <= yEnd; ++y) {
+                int64_t ddy = int64_t(y) - center.y;
+                for (int x = xStart; x <= xEnd; ++x) {
+                    int64_t ddx = int64_t(x) - center.x;
+                    if (ddx * ddx + ddy * ddy <= radiusSq && isWalkable(x, y))
+                        out.push_back({ x, y });
+                }
+            }
+        }
+    }
+}
+
+int SpatialQuery::maxHeightIn(int x0, int y0, int x1, int y1) const {
+    x0 = std::clamp(x0, 0, width - 1);
+    x1 = std::clamp(x1, 0, width - 1);
+    y0 = std::clamp(y0, 0, depth - 1);
+    y1 = std::clamp(y1, 0, depth - 1);
+
+    // Coarsest detail needed: the first level where the box spans at most 2x2 cells
+    size_t l = 0;
+    while (l + 1 < pyramid.size() &&
+           (x1 / pyramid[l].cellSize - x0 / pyramid[l].cellSize > 1 ||
+            y1 / pyramid[l].cellSize - y0 / pyramid[l].cellSize > 1)) {
+        ++l;
+    }
+
+    const Level& level = pyramid[l];
+    int result = level.cells[size_t(y0 / level.cellSize) * level.cellsX + x0 / level.cellSize].max;
+    for (int cy = y0 / level.cellSize; cy <= y1 / level.cellSize; ++cy)
+        for (int cx = x0 / level.cellSize; cx <= x1 / level.cellSize; ++cx)
+            result = std::max(result, level.cells[size_t(cy) * level.cellsX + cx].max);
+    return result;
+}
+
+bool SpatialQuery::segmentClear(TilePos from, int dx, int dy, int steps,
+                                float startH, float endH, int i0, int i1) const {
+    auto lineHeight = [&](int i) { return startH + (endH - startH) * i / steps; };
+
+    if (i1 - i0 < chunkSize) {
+        for (int i = i0; i <= i1; ++i) {
+            TilePos p = pointOnLine(from, dx, dy, steps, i);
+            if (heightAt(p.x, p.y) > lineHeight(i))
+                return false;
+        }
+        return true;
+    }
+
+    // The sight line is straight, so its lowest point over the segment is an end
+    TilePos a = pointOnLine(from, dx, dy, steps, i0);
+    TilePos b = pointOnLine(from, dx, dy, steps, i1);
+    float lowest = std::min(lineHeight(i0), lineHeight(i1));
+    if (maxHeightIn(std::min(a.x, b.x), std::min(a.y, b.y),
+                    std::max(a.x, b.x), std::max(a.y, b.y)) <= lowest)
+        return true;
+
+    int mid = (i0 + i1) / 2;
+    return segmentClear(from, dx, dy, steps, startH, endH, i0, mid) &&
+           segmentClear(from, dx, dy, steps, startH, endH, mid + 1, i1);
+}
+
+bool SpatialQuery::hasLineOfSight(TilePos from, TilePos to, float eyeHeight) const {
+    int dx = to.x - from.x;
+    int dy = to.y - from.y;
+    int steps = std::max(std::abs(dx), std::abs(dy));
+    if (steps <= 1 || pyramid.empty())
+        return true;
+
+    float startH = heightAt(from.x, from.y) + eyeHeight;
+    float endH = heightAt(to.x, to.y) + eyeHeight;
+    return segmentClear(from, dx, dy, steps, startH, endH, 1, steps - 1);
+}
+
+void SpatialQuery::runBatch(size_t count, unsigned threads, const std::function<void(size_t)>& fn) const {
+    std::call_once(poolOnce, [this]() { pool = std::make_unique<WorkerPool>(); });
+
+    if (threads == 0)
+        threads = pool->threadCount();
+    size_t useful = (count + minQueriesPerThread - 1) / minQueriesPerThread;
+    unsigned slices = unsigned(std::min<size_t>({ threads, pool->threadCount(), useful }));
+    pool->parallelFor(count, slices, fn);
+}
+
+void SpatialQuery::heightsAlongRays(const std::vector<RayQuery>& queries,
+                                    std::vector<std::vector<int>>& out, unsigned threads) const {
+    out.resize(queries.size());
+    runBatch(queries.size(), threads, [&](size_t i) {
+        heightsAlongRay(queries[i].from, queries[i].to, out[i]);
+    });
+}
+
+void SpatialQuery::walkableWithinRadii(const std::vector<RadiusQuery>& queries,
+                                       std::vector<std::vector<TilePos>>& out, unsigned threads) const {
+    out.resize(queries.size());
+    runBatch(queries.size(), threads, [&](size_t i) {
+        walkableWithinRadius(queries[i].center, queries[i].radius, out[i]);
+    });
+}
+
+void SpatialQuery::lineOfSight(const std::vector<SightQuery>& queries,
+                               std::vector<uint8_t>& out, unsigned threads) const {
+    out.resize(queries.size());
+    runBatch(queries.size(), threads, [&](size_t i) {
+        out[i] = hasLineOfSight(queries[i].from, queries[i].to, queries[i].eyeHeight);
+    });
+}
@@ -0,0 +1,98 @@
+#include "worker_pool.hpp"
+#include <algorithm>
+
+WorkerPool::WorkerPool(unsigned workers) {
+    if (workers == 0)
+        workers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+    for (unsigned i = 0; i < workers; ++i)
+        threads.emplace_back([this]() { workerLoop(); });
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        stopping = true;
+    }
+    jobReady.notify_all();
+    for (auto& t : threads)
+        t.join();
+}
+
+unsigned WorkerPool::threadCount() const {
+    return unsigned(threads.size()) + 1;
+}
+
+void WorkerPool::parallelFor(size_t count, unsigned slices, const std::function<void(size_t)>& fn) {
+    if (count == 0)
+        return;
+
+    slices = unsigned(std::clamp<size_t>(slices, 1, count));
+    if (slices == 1 || threads.empty()) {
+        for (size_t i = 0; i < count; ++i)
+            fn(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit(submitMutex);
+    std::unique_lock<std::mutex> lock(jobMutex);
+    job = &fn;
+    jobCount = count;
+    jobSlices = slices;
+    nextSlice = 0;
+    slicesDone = 0;
+    failure = nullptr;
+    ++generation;
+    jobReady.notify_all();
+
+    runSlices(lock);
+    jobDone.wait(lock, [this]() { return slicesDone == jobSlices; });
+
+    job = nullptr;
+    std::exception_ptr error = failure;
+    failure = nullptr;
+    lock.unlock();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void WorkerPool::workerLoop() {
+    unsigned long seen = 0;
+    std::unique_lock<std::mutex> lock(jobMutex);
+    while (true) {
+        jobReady.wait(lock, [&]() { return stopping || generation != seen; });
+        if (stopping)
+            return;
+        seen = generation;
+        runSlices(lock);
+    }
+}
+
+void WorkerPool::runSlices(std::unique_lock<std::mutex>& lock) {
+    while (job && nextSlice < jobSlices) {
+        unsigned slice = nextSlice++;
+        const auto& fn = *job;
+        size_t perSlice = (jobCount + jobSlices - 1) / jobSlices;
+        size_t begin = std::min(jobCount, slice * perSlice);
+        size_t end = std::min(jobCount, begin + perSlice);
+        bool skip = failure != nullptr;
+
+        lock.unlock();
+        std::exception_ptr error;
+        if (!skip) {
+            try {
+                for (size_t i = begin; i < end; ++i)
+                    fn(i);
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+        lock.lock();
+
+        if (error && !failure)
+            failure = error;
+        if (++slicesDone == jobSlices)
+            jobDone.notify_all();
+    }
+}
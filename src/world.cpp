@@ -3,13 +3,25 @@
 #include <stdexcept>
 #include <cstdlib>
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <queue>
+#include <tuple>
 #include "globals.hpp"
 #include <set>
+#include <cmath>
 
-World::World(SDL_Renderer* renderer, int width, int height)
-    : renderer(renderer), width(width), height(height) {
+namespace {
+
+const int tileWidth = 64;
+const int tileHeight = 32;
+const int verticalOverlap = tileHeight / 4;
+const int tilesPerHeight = 4;
+
+} // namespace
+
+World::World(SDL_Renderer* renderer, int width, int height, unsigned int seed)
+    : renderer(renderer), width(width), height(height), seed(seed) {
 
     grassTexture = loadTexture("../assets/grass-2.png");
     waterTexture = loadTexture("../assets/water-1.png");
@@ -50,8 +62,10 @@ SDL_Texture* World::loadTexture(const char* path) {
 }
 
 void World::generateWorld() {
-    srand(SDL_GetTicks());
+    srand(seed);
     tiles.clear();
+    mountainCenters.clear();
+    lakeCenters.clear();
 
     for (int y = 0; y < height; ++y) {
         for (int x = 0; x < width; ++x) {
@@ -80,6 +94,9 @@ void World::generateWorld() {
 
     // generateBush(15);
     // generateDirt(5);
+
+    spatialQuery.build(heightMap, lakeSeed);
+    buildRenderCache();
 }
 
 void World::generateMountains(int numPlateaus, int plateauRadius, int minHeight, int maxHeight, int falloffRadius){
@@ -96,6 +113,7 @@ void World::generateMountains(int numPlateaus, int plateauRadius, int minHeight,
         }
 
         int peakH = rand()%range + minHeight;
+        mountainCenters.push_back({centerX, centerY});
 
         std::set<std::pair<int, int>> coreTiles;
         std::queue<std::pair<int, int>> q;
@@ -181,6 +199,8 @@ void World::generateValleys(int numValleys, int minDepth, int maxDepth) {
         int range = maxDepth - minDepth + 1;
 
         int peakH = -(rand()%range + minDepth);
+        if (makeLake)
+            lakeCenters.push_back({centerX, centerY});
 
         std::set<std::pair<int, int>> coreTiles;
         std::queue<std::pair<int, int>> q;
@@ -256,21 +276,27 @@ void World::generateValleys(int numValleys, int minDepth, int maxDepth) {
     }
 }
 
-void World::render(int scrollX, int scrollY) {
-    const int tileWidth = 64;
-    const int tileHeight = 32;
-    const int verticalOverlap = tileHeight / 4;
-    const int tilesPerHeight = 4;
-
-    int scaledTileWidth = tileWidth * zoom;
-    int scaledTileHeight = tileHeight * zoom;
-    int scaledVerticalOverlap = verticalOverlap * zoom;
-
+void World::buildRenderCache() {
+    // Draw order only depends on grid position, so sort once instead of every frame
     std::sort(tiles.begin(), tiles.end(), [](const TileInstance& a, const TileInstance& b) {
-        return (a.gridX + a.gridY) < (b.gridX + b.gridY);
+        int da = a.gridX + a.gridY;
+        int db = b.gridX + b.gridY;
+        return da != db ? da < db : a.gridX < b.gridX;
     });
 
-    for (const auto& t : tiles) {
+    shading.clear();
+    shading.reserve(tiles.size());
+    diagonalStart.assign(width + height, tiles.size());
+    maxTileHeight = 0;
+    minTileHeight = 0;
+
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        const TileInstance& t = tiles[i];
+        int d = t.gridX + t.gridY;
+        diagonalStart[d] = std::min(diagonalStart[d], i);
+        maxTileHeight = std::max(maxTileHeight, t.height);
+        minTileHeight = std::min(minTileHeight, t.height);
+
         SDL_Texture* topTex;
 
         switch(t.type){
@@ -287,95 +313,214 @@ void World::render(int scrollX, int scrollY) {
                 topTex = grassTexture;
         }
 
-        SDL_Texture* wallTex = cliffTexture;
+        // Top surface brightness
+        int topBrightness = 180 + t.height * 20;
+        if (getHeightAt(t.gridX - 1, t.gridY) > t.height)
+            topBrightness -= 40;
+        topBrightness = std::clamp(topBrightness, 40, 255);
 
-        int baseX = (t.gridX - t.gridY) * (tileWidth / 2);
-        int baseY = (t.gridX + t.gridY) * (tileHeight / 2);
+        shading.push_back({
+            topTex,
+            topBrightness,
+            getHeightAt(t.gridX + 1, t.gridY),
+            getHeightAt(t.gridX, t.gridY - 1),
+            getHeightAt(t.gridX, t.gridY + 1),
+            lakeSeed[t.gridX][t.gridY]
+        });
+    }
 
-        int isoX = int((baseX - scrollX) * zoom + 0.5f);
-        int isoY = int((baseY - scrollY) * zoom + 0.5f);
-        int topY = isoY - int(t.height * tilesPerHeight * scaledVerticalOverlap + 0.5f);
+    zoomCache.clear();
+}
 
-        auto applyWallShadow = [&](int pixelY, int tileH, int x, int y) {
-            int brightness = 255;
+const World::ZoomMetrics& World::metricsFor(float zoom) {
+    auto it = zoomCache.find(zoom);
+    if (it != zoomCache.end())
+        return it->second;
 
-            // Depth-based darkness for valleys
-            float tileHeightAtPixel = tileH + float(pixelY) / tilesPerHeight;
-            if (tileHeightAtPixel < 0.0f)
-                brightness -= pixelY * 10;
+    // Zoom normally moves in 0.1 steps; don't let arbitrary values grow the cache forever
+    if (zoomCache.size() >= 64)
+        zoomCache.clear();
 
-            // Base lighting bias (optional)
-            brightness += 10;
+    ZoomMetrics m;
+    m.scaledTileWidth = tileWidth * zoom;
+    m.scaledTileHeight = tileHeight * zoom;
+    m.scaledVerticalOverlap = verticalOverlap * zoom;
 
-            // Apply shadow from higher tiles in shadow-casting directions
-            if (getHeightAt(x + 1, y) > tileH)     brightness -= 30; // Right tile casts shadow
-            if (getHeightAt(x,     y - 1) > tileH) brightness -= 30; // Top tile casts shadow
+    // Mountain tops rise above the base; valley walls reach up to twice the depth below it
+    // (+1 each for rounding the wall offsets)
+    m.padAbove = int(std::ceil(maxTileHeight * tilesPerHeight * m.scaledVerticalOverlap)) + 3;
+    m.padBelow = int(std::ceil(-minTileHeight * 2 * tilesPerHeight * m.scaledVerticalOverlap))
+                 + m.scaledTileHeight + 5;
 
-            return std::clamp(brightness, 20, 255);
-        };
+    return zoomCache.emplace(zoom, m).first->second;
+}
 
-        // MOUNTAIN WALLS
-        if (t.height > 0) {
-            for (int h = t.height * tilesPerHeight; h >= 1; --h) {
-                SDL_Rect cliffDst = { isoX, topY + h * scaledVerticalOverlap, scaledTileWidth, scaledTileHeight };
-                int brightness = applyWallShadow(h, t.height, t.gridX, t.gridY);
-                SDL_SetTextureColorMod(wallTex, brightness, brightness, brightness);
-                SDL_RenderCopy(renderer, wallTex, nullptr, &cliffDst);
-            }
+void World::render(const Viewport& view) {
+    const Camera& cam = view.camera;
+    const ZoomMetrics& m = metricsFor(cam.zoom);
+
+    SDL_RenderSetViewport(renderer, &view.rect);
+
+    // Screen Y only depends on the diagonal (gridX + gridY), screen X on gridX
+    // within a diagonal, so the visible tiles are a contiguous run per diagonal
+    const float halfW = tileWidth / 2;
+    const float halfH = tileHeight / 2;
+    int diagonals = width + height - 1;
+    int firstD = std::max(0, int(std::floor((cam.scrollY - m.padBelow / cam.zoom) / halfH)) - 1);
+    int lastD = std::min(diagonals - 1,
+                         int(std::ceil((cam.scrollY + (view.rect.h + m.padAbove) / cam.zoom) / halfH)) + 1);
+    float leftX = (cam.scrollX - (m.scaledTileWidth + 2) / cam.zoom) / halfW;
+    float rightX = (cam.scrollX + (view.rect.w + 2) / cam.zoom) / halfW;
+
+    for (int d = firstD; d <= lastD; ++d) {
+        int minGX = std::max(0, d - (height - 1));
+        int maxGX = std::min(width - 1, d);
+
+        // baseX = (2 * gridX - d) * halfW
+        int fromGX = std::max(minGX, int(std::floor((d + leftX) / 2)) - 1);
+        int toGX = std::min(maxGX, int(std::ceil((d + rightX) / 2)) + 1);
+
+        for (int gx = fromGX; gx <= toGX; ++gx) {
+            size_t i = diagonalStart[d] + (gx - minGX);
+            const TileInstance& t = tiles[i];
+
+            int baseX = (t.gridX - t.gridY) * (tileWidth / 2);
+            int baseY = (t.gridX + t.gridY) * (tileHeight / 2);
+
+            int isoX = int((baseX - cam.scrollX) * cam.zoom + 0.5f);
+            int isoY = int((baseY - cam.scrollY) * cam.zoom + 0.5f);
+            renderTile(t, shading[i], isoX, isoY, m);
         }
-        // VALLEY WALLS
-        else if (t.height < 0) {
-            int totalSubTiles = -t.height * tilesPerHeight;
-            for (int s = 0; s <= totalSubTiles; ++s) {
-                SDL_Rect cliffDst = { isoX, topY + s * scaledVerticalOverlap, scaledTileWidth, scaledTileHeight };
-                int brightness = applyWallShadow(s, t.height, t.gridX, t.gridY);
-                SDL_SetTextureColorMod(wallTex, brightness, brightness, brightness);
-                SDL_RenderCopy(renderer, wallTex, nullptr, &cliffDst);
-            }
-            SDL_SetTextureColorMod(wallTex, 255, 255, 255); // reset
+    }
+
+    SDL_RenderSetViewport(renderer, nullptr);
+}
+
+void World::renderTile(const TileInstance& t, const TileShading& s, int isoX, int isoY, const ZoomMetrics& m) {
+    int scaledTileWidth = m.scaledTileWidth;
+    int scaledTileHeight = m.scaledTileHeight;
+    float scaledVerticalOverlap = m.scaledVerticalOverlap;
+
+    SDL_Texture* topTex = s.topTex;
+    SDL_Texture* wallTex = cliffTexture;
+
+    int topY = isoY - int(t.height * tilesPerHeight * scaledVerticalOverlap + 0.5f);
+
+    auto applyWallShadow = [&](int pixelY, int tileH) {
+        int brightness = 255;
+
+        // Depth-based darkness for valleys
+        float tileHeightAtPixel = tileH + float(pixelY) / tilesPerHeight;
+        if (tileHeightAtPixel < 0.0f)
+            brightness -= pixelY * 10;
+
+        // Base lighting bias (optional)
+        brightness += 10;
+
+        // Apply shadow from higher tiles in shadow-casting directions
+        if (s.heightRight > tileH) brightness -= 30; // Right tile casts shadow
+        if (s.heightUp > tileH)    brightness -= 30; // Top tile casts shadow
+
+        return std::clamp(brightness, 20, 255);
+    };
+
+    // MOUNTAIN WALLS
+    if (t.height > 0) {
+        for (int h = t.height * tilesPerHeight; h >= 1; --h) {
+            SDL_Rect cliffDst = { isoX, topY + int(h * scaledVerticalOverlap + 0.5f), scaledTileWidth, scaledTileHeight };
+            int brightness = applyWallShadow(h, t.height);
+            SDL_SetTextureColorMod(wallTex, brightness, brightness, brightness);
+            SDL_RenderCopy(renderer, wallTex, nullptr, &cliffDst);
         }
+    }
+    // VALLEY WALLS
+    else if (t.height < 0) {
+        int totalSubTiles = -t.height * tilesPerHeight;
+        for (int sub = 0; sub <= totalSubTiles; ++sub) {
+            SDL_Rect cliffDst = { isoX, topY + int(sub * scaledVerticalOverlap + 0.5f), scaledTileWidth, scaledTileHeight };
+            int brightness = applyWallShadow(sub, t.height);
+            SDL_SetTextureColorMod(wallTex, brightness, brightness, brightness);
+            SDL_RenderCopy(renderer, wallTex, nullptr, &cliffDst);
+        }
+        SDL_SetTextureColorMod(wallTex, 255, 255, 255); // reset
+    }
 
-        // GAP-FILLING WALLS TO RIGHT/BOTTOM NEIGHBORS
-        for (auto [dx, dy] : { std::pair{1, 0}, std::pair{0, 1} }) {
-            int nx = t.gridX + dx;
-            int ny = t.gridY + dy;
-            int neighborH = getHeightAt(nx, ny);
-            int heightDiff = t.height - neighborH;
-            if (heightDiff > 0) {
-                for (int h = 1; h <= heightDiff * tilesPerHeight; ++h) {
-                    SDL_Rect cliffDst = { isoX, topY + h * scaledVerticalOverlap, scaledTileWidth, scaledTileHeight };
-                    int brightness = applyWallShadow(h, neighborH, t.gridX, t.gridY);
-                    SDL_SetTextureColorMod(wallTex, brightness, brightness, brightness);
-                    SDL_RenderCopy(renderer, wallTex, nullptr, &cliffDst);
-                }
-                SDL_SetTextureColorMod(wallTex, 255, 255, 255);
+    // GAP-FILLING WALLS TO RIGHT/BOTTOM NEIGHBORS
+    for (int neighborH : { s.heightRight, s.heightDown }) {
+        int heightDiff = t.height - neighborH;
+        if (heightDiff > 0) {
+            for (int h = 1; h <= heightDiff * tilesPerHeight; ++h) {
+                SDL_Rect cliffDst = { isoX, topY + int(h * scaledVerticalOverlap + 0.5f), scaledTileWidth, scaledTileHeight };
+                int brightness = applyWallShadow(h, neighborH);
+                SDL_SetTextureColorMod(wallTex, brightness, brightness, brightness);
+                SDL_RenderCopy(renderer, wallTex, nullptr, &cliffDst);
             }
+            SDL_SetTextureColorMod(wallTex, 255, 255, 255);
         }
+    }
 
-        // Top surface brightness
-        int topBrightness = 180 + t.height * 20;
-        if (getHeightAt(t.gridX - 1, t.gridY) > t.height)
-            topBrightness -= 40;
-        topBrightness = std::clamp(topBrightness, 40, 255);
-        SDL_SetTextureColorMod(topTex, topBrightness, topBrightness, topBrightness);
+    SDL_SetTextureColorMod(topTex, s.topBrightness, s.topBrightness, s.topBrightness);
 
-        SDL_Rect topDst = { isoX - 2, topY - 2, scaledTileWidth + 3, scaledTileHeight + 3 };
-        SDL_RenderCopy(renderer, topTex, nullptr, &topDst);
+    SDL_Rect topDst = { isoX - 2, topY - 2, scaledTileWidth + 3, scaledTileHeight + 3 };
+    SDL_RenderCopy(renderer, topTex, nullptr, &topDst);
 
-        // Render water surface
-        if (lakeSeed[t.gridX][t.gridY]) {
-            SDL_SetTextureBlendMode(waterTexture, SDL_BLENDMODE_BLEND);
-            SDL_SetTextureAlphaMod(waterTexture, 204); // 80%
-            SDL_SetTextureColorMod(waterTexture, 255, 255, 255);
+    // Render water surface
+    if (s.lake) {
+        SDL_SetTextureBlendMode(waterTexture, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureAlphaMod(waterTexture, 204); // 80%
+        SDL_SetTextureColorMod(waterTexture, 255, 255, 255);
 
-            int waterY = int(((t.gridX + t.gridY) * (tileHeight / 2) - scrollY) * zoom + 0.5f);
-            SDL_Rect waterDst = { isoX - 2, waterY - 2, scaledTileWidth + 2, scaledTileHeight + 2 };
-            SDL_RenderCopy(renderer, waterTexture, nullptr, &waterDst);
-            SDL_SetTextureAlphaMod(waterTexture, 255); // reset
-        }
+        SDL_Rect waterDst = { isoX - 2, isoY - 2, scaledTileWidth + 2, scaledTileHeight + 2 };
+        SDL_RenderCopy(renderer, waterTexture, nullptr, &waterDst);
+        SDL_SetTextureAlphaMod(waterTexture, 255); // reset
     }
 }
 
+const std::vector<std::pair<int, int>>& World::getMountainCenters() const {
+    return mountainCenters;
+}
+
+const std::vector<std::pair<int, int>>& World::getLakeCenters() const {
+    return lakeCenters;
+}
+
+const SpatialQuery& World::getSpatialQuery() const {
+    return spatialQuery;
+}
+
+Camera World::cameraCenteredOn(int gridX, int gridY, float zoom, int viewW, int viewH) const {
+    // Same projection as render(): tile origin plus half a tile, raised by its height
+    float centerX = (gridX - gridY) * (tileWidth / 2) + tileWidth / 2;
+    float centerY = (gridX + gridY) * (tileHeight / 2) + tileHeight / 2
+                    - spatialQuery.heightAt(gridX, gridY) * tilesPerHeight * verticalOverlap;
+
+    Camera cam;
+    cam.zoom = zoom;
+    cam.scrollX = centerX - viewW / 2 / zoom;
+    cam.scrollY = centerY - viewH / 2 / zoom;
+    return cam;
+}
+
+bool World::isLake(int x, int y) const {
+    return x >= 0 && x < width && y >= 0 && y < height && lakeSeed[x][y];
+}
+
+Camera World::cameraShowingWholeWorld(int viewW, int viewH) const {
+    // Unzoomed isometric bounds: same extents render() uses for culling
+    float left = -(height - 1) * (tileWidth / 2) - 2;
+    float right = (width - 1) * (tileWidth / 2) + tileWidth + 1;
+    float top = -maxTileHeight * tilesPerHeight * verticalOverlap - 2;
+    float bottom = (width + height - 2) * (tileHeight / 2)
+                   - minTileHeight * 2 * tilesPerHeight * verticalOverlap + tileHeight + 3;
+
+    Camera cam;
+    cam.zoom = std::min(viewW / (right - left), viewH / (bottom - top));
+    // Center the world in the view
+    cam.scrollX = (left + right) / 2 - viewW / 2 / cam.zoom;
+    cam.scrollY = (top + bottom) / 2 - viewH / 2 / cam.zoom;
+    return cam;
+}
+
 int World::getHeightAt(int x, int y) {
     if (x>=0 && x<heightMap.size() && y>=0 && y<heightMap[0].size()){
         return heightMap[x][y];